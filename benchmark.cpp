@@ -9,6 +9,8 @@
 #include <algorithm>
 #include <iomanip>
 #include <numeric>
+#include "static_index.hpp"
+#include "result_writer.hpp"
 
 using namespace std;
 using namespace chrono;
@@ -38,87 +40,77 @@ vector<pair<string, DNAInfo>> load_csv(const string &filename) {
     return dataset;
 }
 
+// Perkiraan memori heap sebuah string (0 jika muat di buffer SSO)
+size_t stringHeapBytes(const string& s) {
+    const char* p = s.data();
+    const char* self = reinterpret_cast<const char*>(&s);
+    if (p >= self && p < self + sizeof(string)) return 0;
+    return s.capacity() + 1;
+}
+
+size_t estimateMemory(const unordered_map<string, DNAInfo>& um) {
+    // node: next pointer + pair + cached hash, plus the bucket array
+    size_t total = um.bucket_count() * sizeof(void*);
+    total += um.size() * (sizeof(void*) + sizeof(pair<const string, DNAInfo>) + sizeof(size_t));
+    for (const auto& e : um)
+        total += stringHeapBytes(e.first) + stringHeapBytes(e.second.species) + stringHeapBytes(e.second.mutation);
+    return total;
+}
+
+size_t estimateMemory(const map<string, DNAInfo>& mp) {
+    // node: color + parent/left/right pointers + pair
+    size_t total = mp.size() * (4 * sizeof(void*) + sizeof(pair<const string, DNAInfo>));
+    for (const auto& e : mp)
+        total += stringHeapBytes(e.first) + stringHeapBytes(e.second.species) + stringHeapBytes(e.second.mutation);
+    return total;
+}
+
 void findSingle(const unordered_map<string, DNAInfo>& um,
                 const map<string, DNAInfo>& mp,
-                const string& key) {
-    
-    cout << "\n=== Find Result for key: '" << key << "' ===\n";
-    cout << left << setw(12) << "Structure" << " | "
-         << setw(20) << "Key" << " | "
-         << setw(15) << "Species" << " | "
-         << setw(15) << "Mutation" << " | "
-         << "Time (ns)" << "\n";
-    cout << string(12, '-') << "-|-" << string(20, '-') << "-|-"
-         << string(15, '-') << "-|-" << string(15, '-') << "-|-"
-         << string(10, '-') << "\n";
+                const string& key,
+                OutputFormat fmt = OutputFormat::Table) {
 
+    // Search first, format afterwards, so the timings contain no I/O
     auto t0 = high_resolution_clock::now();
     auto it_um = um.find(key);
     auto t1 = high_resolution_clock::now();
     long long t_um = duration_cast<nanoseconds>(t1 - t0).count();
 
-    if (it_um != um.end()) {
-        cout << left << setw(12) << "HashMap" << " | "
-             << setw(20) << it_um->first << " | "
-             << setw(15) << it_um->second.species << " | "
-             << setw(15) << it_um->second.mutation << " | "
-             << t_um << "\n";
-    } else {
-        cout << left << setw(12) << "HashMap" << " | "
-             << setw(20) << "Not Found" << " | "
-             << setw(15) << "-" << " | "
-             << setw(15) << "-" << " | "
-             << t_um << "\n";
-    }
-
     auto t2 = high_resolution_clock::now();
     auto it_mp = mp.find(key);
     auto t3 = high_resolution_clock::now();
     long long t_mp = duration_cast<nanoseconds>(t3 - t2).count();
-    
-    if (it_mp != mp.end()) {
-        cout << left << setw(12) << "B+ Tree" << " | "
-             << setw(20) << it_mp->first << " | "
-             << setw(15) << it_mp->second.species << " | "
-             << setw(15) << it_mp->second.mutation << " | "
-             << t_mp << "\n";
-    } else {
-        cout << left << setw(12) << "B+ Tree" << " | "
-             << setw(20) << "Not Found" << " | "
-             << setw(15) << "-" << " | "
-             << setw(15) << "-" << " | "
-             << t_mp << "\n";
-        
-        cout << string(85, '-') << "\n";
-        cout << "B+ Tree can find nearby elements:\n";
 
-        auto lb = mp.lower_bound(key);
-        if (lb != mp.end()) {
-            cout << left << setw(12) << "Lower Bound" << " | "
-                 << setw(20) << lb->first << " | "
-                 << setw(15) << lb->second.species << " | "
-                 << setw(15) << lb->second.mutation << " | \n";
-        } else {
-            cout << left << setw(12) << "Lower Bound" << " | " << "Not Found (key is > all elements)\n";
-        }
+    auto f0 = high_resolution_clock::now();
+    auto out = makeResultWriter(fmt);
+    out->note("\n=== Find Result for key: '" + key + "' ===\n");
+    out->header();
+
+    out->row(makeRow("HashMap", key, it_um, it_um != um.end(), t_um));
+    out->row(makeRow("B+ Tree", key, it_mp, it_mp != mp.end(), t_mp));
 
+    if (it_mp == mp.end()) {
+        out->note(string(85, '-') + "\n");
+        out->note("B+ Tree can find nearby elements:\n");
+        auto lb = mp.lower_bound(key);
+        out->row(makeRow("Lower Bound", key, lb, lb != mp.end(), -1));
         auto ub = mp.upper_bound(key);
-        if (ub != mp.end()) {
-            cout << left << setw(12) << "Upper Bound" << " | "
-                 << setw(20) << ub->first << " | "
-                 << setw(15) << ub->second.species << " | "
-                 << setw(15) << ub->second.mutation << " | \n";
-        } else {
-             cout << left << setw(12) << "Upper Bound" << " | " << "Not Found (key is >= all elements)\n";
-        }
+        out->row(makeRow("Upper Bound", key, ub, ub != mp.end(), -1));
     }
-    cout << "\n";
+    out->flush();
+    long long t_fmt = duration_cast<nanoseconds>(high_resolution_clock::now() - f0).count();
+    out->note("Format time: " + to_string(t_fmt) + " ns\n\n");
 }
 
 
 int main(int argc, char *argv[]) {
-    if (argc < 2 || argc > 3) {
-        cerr << "Usage: " << argv[0] << " <data.csv> [key_to_find]\n";
+    if (argc < 2 || argc > 4) {
+        cerr << "Usage: " << argv[0] << " <data.csv> [key_to_find] [table|tsv|jsonl|bin]\n";
+        return 1;
+    }
+    OutputFormat fmt = OutputFormat::Table;
+    if (argc == 4 && !parseOutputFormat(argv[3], fmt)) {
+        cerr << "Unknown output format: " << argv[3] << "\n";
         return 1;
     }
 
@@ -129,15 +121,19 @@ int main(int argc, char *argv[]) {
         return 1;
     }
     
+    // Format mesin (tsv/jsonl/bin): stdout hanya berisi baris hasil,
+    // semua teks lain (banner, tabel benchmark) ke stderr
+    ostream& info = fmt == OutputFormat::Table ? cout : clog;
+
     const int n = full_data.size();
     const int num_runs = 100;
-    cout << "=== Dataset Size: " << n << ", Benchmark Runs: " << num_runs << " ===\n";
+    info << "=== Dataset Size: " << n << ", Benchmark Runs: " << num_runs << " ===\n";
 
-    if (argc == 3) {
+    if (argc >= 3) {
         string key_to_find = argv[2];
         unordered_map<string, DNAInfo> um_single(full_data.begin(), full_data.end());
         map<string, DNAInfo> mp_single(full_data.begin(), full_data.end());
-        findSingle(um_single, mp_single, key_to_find);
+        findSingle(um_single, mp_single, key_to_find, fmt);
     }
     
     unordered_map<string, DNAInfo> um;
@@ -163,6 +159,20 @@ int main(int argc, char *argv[]) {
     }
     double create_mp = static_cast<double>(total_time) / num_runs;
 
+    StaticIndexDS sx;
+    bool static_ok = true;
+    total_time = 0;
+    for(int i = 0; i < num_runs && static_ok; ++i) {
+        auto start = high_resolution_clock::now();
+        static_ok = sx.build(full_data);
+        total_time += duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+    }
+    double create_sx = static_cast<double>(total_time) / num_runs;
+    if (!static_ok) {
+        cerr << "Static index skipped: keys must be A/C/G/T only, max "
+             << StaticIndexDS::MAX_BASES << " bases.\n";
+    }
+
 
     // Isi map sekali untuk benchmark Find, Update, Delete
     um.clear(); mp.clear();
@@ -198,6 +208,65 @@ int main(int argc, char *argv[]) {
     }
     double find_mp = static_cast<double>(total_time) / num_runs;
 
+    total_time = 0;
+    for(int i = 0; i < num_runs && static_ok; ++i) {
+        volatile size_t find_count_sx = 0;
+        DNAInfo rec;
+        auto start = high_resolution_clock::now();
+        for (const auto &e : full_data) {
+            if (sx.find(e.first, rec)) {
+                find_count_sx++;
+            }
+        }
+        total_time += duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+    }
+    double find_sx = static_cast<double>(total_time) / num_runs;
+
+    // -- 2b. BENCHMARK PREFIX (3 basa pertama tiap key) --
+    vector<string> prefixes;
+    prefixes.reserve(n);
+    for (const auto &e : full_data) prefixes.push_back(e.first.substr(0, 3));
+
+    total_time = 0;
+    for(int i = 0; i < num_runs; ++i) {
+        volatile size_t prefix_count_mp = 0;
+        auto start = high_resolution_clock::now();
+        for (const auto &p : prefixes) {
+            vector<pair<string, DNAInfo>> results;
+            for (auto it = mp.lower_bound(p); it != mp.end(); ++it) {
+                if (it->first.compare(0, p.size(), p) != 0) break;
+                results.push_back(*it);
+            }
+            prefix_count_mp += results.size();
+        }
+        total_time += duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+    }
+    double prefix_mp = static_cast<double>(total_time) / num_runs;
+
+    total_time = 0;
+    for(int i = 0; i < num_runs && static_ok; ++i) {
+        volatile size_t prefix_count_sx = 0;
+        auto start = high_resolution_clock::now();
+        for (const auto &p : prefixes) {
+            vector<pair<string, DNAInfo>> results;
+            prefix_count_sx += sx.prefixSearch(p, results);
+        }
+        total_time += duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+    }
+    double prefix_sx = static_cast<double>(total_time) / num_runs;
+
+    size_t mem_um = estimateMemory(um);
+    size_t mem_mp = estimateMemory(mp);
+    size_t mem_sx = static_ok ? sx.bytes() : 0;
+
+    // Kolom Static: "n/a" jika index gagal dibangun, bukan angka palsu
+    auto static_cell = [&](double v) {
+        if (!static_ok) return string("n/a");
+        ostringstream os;
+        os << fixed << setprecision(2) << v;
+        return os.str();
+    };
+
     // -- 3. BENCHMARK UPDATE --
     auto start_update = high_resolution_clock::now();
     for (auto &e : um) { e.second.species += "_upd"; }
@@ -224,25 +293,40 @@ int main(int argc, char *argv[]) {
     double delete_mp = duration_cast<nanoseconds>(high_resolution_clock::now() - start_delete).count();
 
     // -- Tampilan Hasil Benchmark --
-    cout << "\n=== Full Dataset Benchmark Results ===\n";
-    cout << "Avg. time per element (ns)\n";
-    cout << left << setw(15) << "Operation"
+    info << "\n=== Full Dataset Benchmark Results ===\n";
+    info << "Avg. time per element (ns)\n";
+    info << left << setw(15) << "Operation"
          << "| " << right << setw(18) << "HashMap (ns)"
-         << " | " << setw(18) << "B+ Tree (ns)" << "\n";
-    cout << string(15, '-') << "+--------------------+------------------\n";
-    cout << fixed << setprecision(2);
-    cout << left << setw(15) << "Create"
+         << " | " << setw(18) << "B+ Tree (ns)"
+         << " | " << setw(18) << "Static (ns)" << "\n";
+    info << string(15, '-') << "+--------------------+--------------------+------------------\n";
+    info << fixed << setprecision(2);
+    info << left << setw(15) << "Create"
          << "| " << right << setw(18) << create_um / n
-         << " | " << setw(18) << create_mp / n << "\n";
-    cout << left << setw(15) << "Find"
+         << " | " << setw(18) << create_mp / n
+         << " | " << setw(18) << static_cell(create_sx / n) << "\n";
+    info << left << setw(15) << "Find"
          << "| " << right << setw(18) << find_um / n
-         << " | " << setw(18) << find_mp / n << "\n";
-    cout << left << setw(15) << "Update"
+         << " | " << setw(18) << find_mp / n
+         << " | " << setw(18) << static_cell(find_sx / n) << "\n";
+    info << left << setw(15) << "Prefix (3)"
+         << "| " << right << setw(18) << "n/a"
+         << " | " << setw(18) << prefix_mp / n
+         << " | " << setw(18) << static_cell(prefix_sx / n) << "\n";
+    info << left << setw(15) << "Update"
          << "| " << right << setw(18) << update_um / n
-         << " | " << setw(18) << update_mp / n << "\n";
-    cout << left << setw(15) << "Delete"
+         << " | " << setw(18) << update_mp / n
+         << " | " << setw(18) << "read-only" << "\n";
+    info << left << setw(15) << "Delete"
          << "| " << right << setw(18) << delete_um / n
-         << " | " << setw(18) << delete_mp / n << "\n\n";
+         << " | " << setw(18) << delete_mp / n
+         << " | " << setw(18) << "read-only" << "\n\n";
+
+    info << "Estimated memory (bytes)\n";
+    info << left << setw(15) << "Memory"
+         << "| " << right << setw(18) << mem_um
+         << " | " << setw(18) << mem_mp
+         << " | " << setw(18) << (static_ok ? to_string(mem_sx) : string("n/a")) << "\n\n";
     
     return 0;
 }
\ No newline at end of file
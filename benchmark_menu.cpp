@@ -1,11 +1,39 @@
 #include "benchmark_menu.hpp"
+#include <memory>
+
+static void printRows(const Rows& rows) {
+    for (auto& kv : rows)
+        cout << "    • " << kv.first << ": " << kv.second.species << ", " << kv.second.mutation << "\n";
+}
+
+static const size_t MAX_CACHE_ENTRIES = 1 << 20;
 
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        cerr << "Usage: " << argv[0] << " <data.csv>\n";
+    if (argc < 2 || argc > 3) {
+        cerr << "Usage: " << argv[0] << " <data.csv> [--cache[=entries]]\n";
         return 1;
     }
 
+    unique_ptr<QueryCache> cache;
+    if (argc == 3) {
+        string opt = argv[2];
+        size_t entries = 1024;
+        if (opt.rfind("--cache=", 0) == 0) {
+            string num = opt.substr(8);
+            if (num.empty() || num.size() > 8 || num.find_first_not_of("0123456789") != string::npos ||
+                (entries = stoul(num)) == 0 || entries > MAX_CACHE_ENTRIES) {
+                cerr << "Invalid cache size: " << num << " (expected 1.." << MAX_CACHE_ENTRIES << ")\n";
+                cerr << "Usage: " << argv[0] << " <data.csv> [--cache[=entries]]\n";
+                return 1;
+            }
+        }
+        else if (opt != "--cache") {
+            cerr << "Unknown option: " << opt << "\n";
+            return 1;
+        }
+        cache.reset(new QueryCache(entries));
+    }
+
     vector<pair<string, Record>> data;
     if (!loadCSV(argv[1], data)) {
         cerr << "Failed to open or parse CSV: " << argv[1] << "\n";
@@ -24,7 +52,8 @@ int main(int argc, char* argv[]) {
     long t_bpt_init = chrono::duration_cast<Micros>(t2 - t1).count();
     printBenchmark(t_hm_init, t_bpt_init);
 
-    cout << "\nType commands: find/create/read/update/delete/exit\n";
+    cout << "\nType commands: find/create/read/update/delete/prefix/range"
+         << (cache ? "/stats" : "") << "/exit\n";
 
     string line;
     while (true) {
@@ -48,6 +77,19 @@ int main(int argc, char* argv[]) {
                 cout << "Usage: " << cmd << " <key>\n";
                 continue;
             }
+            PointResult cached;
+            long t_cache;
+            if (cache && cache->getPoint(key, cached, t_cache)) {
+                if (cached.found) {
+                    cout << "Cache:     ✓ Found \"" << key << "\" (" << t_cache << "µs) -> "
+                         << cached.rec.species << ", " << cached.rec.mutation << "\n";
+                } else {
+                    cout << "Cache:     ✗ \"" << key << "\" not found (" << t_cache << "µs)"
+                         << "  Nearest: [" << cached.nearestKey << "] -> "
+                         << cached.nearest.species << ", " << cached.nearest.mutation << "\n";
+                }
+                continue;
+            }
             // HashMap lookup
             bool okHm = hm.find(key, recHm, t_hm);
             if (okHm) {
@@ -58,16 +100,68 @@ int main(int argc, char* argv[]) {
             }
             // B+Tree lookup
             bool okBpt = bpt.find(key, recBpt, t_bpt);
+            string nk; Record nr;
             if (okBpt) {
                 cout << "B+Tree:    ✓ Found \"" << key << "\" (" << t_bpt << "µs) -> "
                      << recBpt.species << ", " << recBpt.mutation << "\n";
             } else {
-                string nk; Record nr; long t_near;
+                long t_near;
                 bpt.findNearest(key, nk, nr, t_near);
                 cout << "B+Tree:    ✗ \"" << key << "\" not found (" << t_bpt << "µs)"
                      << "  Nearest: [" << nk << "] -> "
                      << nr.species << ", " << nr.mutation << "\n";
             }
+            if (cache) cache->putPoint(key, PointResult{okBpt, recBpt, nk, nr});
+        }
+        else if (cmd == "prefix") {
+            iss >> key;
+            if (key.empty()) {
+                cout << "Usage: prefix <prefix>\n";
+                continue;
+            }
+            RowsPtr rows;
+            long t_cache;
+            if (cache && cache->getPrefix(key, rows, t_cache)) {
+                cout << "Cache:     ✓ " << rows->size() << " record(s) with prefix \""
+                     << key << "\" (" << t_cache << "µs)\n";
+            } else {
+                auto scanned = make_shared<Rows>();
+                bpt.prefixSearch(key, *scanned, t_bpt);
+                rows = scanned;
+                cout << "B+Tree:    " << rows->size() << " record(s) with prefix \""
+                     << key << "\" (" << t_bpt << "µs)\n";
+                if (cache) cache->putPrefix(key, rows);
+            }
+            printRows(*rows);
+        }
+        else if (cmd == "range") {
+            string hi;
+            iss >> key >> hi;
+            if (hi.empty()) {
+                cout << "Usage: range <from_key> <to_key>\n";
+                continue;
+            }
+            RowsPtr rows;
+            long t_cache;
+            if (cache && cache->getRange(key, hi, rows, t_cache)) {
+                cout << "Cache:     ✓ " << rows->size() << " record(s) in [" << key << ", " << hi
+                     << "] (" << t_cache << "µs)\n";
+            } else {
+                auto scanned = make_shared<Rows>();
+                bpt.rangeSearch(key, hi, *scanned, t_bpt);
+                rows = scanned;
+                cout << "B+Tree:    " << rows->size() << " record(s) in [" << key << ", " << hi
+                     << "] (" << t_bpt << "µs)\n";
+                if (cache) cache->putRange(key, hi, rows);
+            }
+            printRows(*rows);
+        }
+        else if (cmd == "stats") {
+            if (!cache) {
+                cout << "Cache disabled, start with --cache[=entries]\n";
+                continue;
+            }
+            cache->printStats();
         }
         else if (cmd == "create") {
             iss >> key >> species >> mutation;
@@ -79,6 +173,7 @@ int main(int argc, char* argv[]) {
             long t_h, t_b;
             hm.create(key, recLocal, t_h);
             bpt.create(key, recLocal, t_b);
+            if (cache) cache->invalidate(key);
             cout << "Created \"" << key << "\" in HashMap(" << t_h
                  << "µs) & B+Tree(" << t_b << "µs)\n";
         }
@@ -91,6 +186,7 @@ int main(int argc, char* argv[]) {
             recLocal = {species, mutation};
             bool uh = hm.update(key, recLocal, t_hm);
             bool ub = bpt.update(key, recLocal, t_bpt);
+            if (cache) cache->invalidate(key);
             if (uh && ub) {
                 cout << "Updated \"" << key << "\" in HashMap(" << t_hm
                      << "µs) & B+Tree(" << t_bpt << "µs)\n";
@@ -106,6 +202,7 @@ int main(int argc, char* argv[]) {
             }
             bool dh = hm.remove(key, t_hm);
             bool db = bpt.remove(key, t_bpt);
+            if (cache) cache->invalidate(key);
             if (dh && db) {
                 cout << "Deleted \"" << key << "\" in HashMap(" << t_hm
                      << "µs) & B+Tree(" << t_bpt << "µs)\n";
@@ -7,6 +7,8 @@
 #include <chrono>
 #include <fstream>
 #include <sstream>
+#include <memory>
+#include "query_cache.hpp"
 
 using namespace std;
 using Clock = chrono::high_resolution_clock;
@@ -103,6 +105,27 @@ public:
         return true;
     }
 
+    size_t prefixSearch(const string& prefix, vector<pair<string, Record>>& out, long& elapsed_us) const {
+        auto start = Clock::now();
+        for (auto it = tree_.lower_bound(prefix); it != tree_.end(); ++it) {
+            if (it->first.compare(0, prefix.size(), prefix) != 0) break;
+            out.emplace_back(it->first, it->second);
+        }
+        auto end = Clock::now();
+        elapsed_us = chrono::duration_cast<Micros>(end - start).count();
+        return out.size();
+    }
+
+    // All keys in [lo, hi]
+    size_t rangeSearch(const string& lo, const string& hi, vector<pair<string, Record>>& out, long& elapsed_us) const {
+        auto start = Clock::now();
+        for (auto it = tree_.lower_bound(lo); it != tree_.end() && it->first <= hi; ++it)
+            out.emplace_back(it->first, it->second);
+        auto end = Clock::now();
+        elapsed_us = chrono::duration_cast<Micros>(end - start).count();
+        return out.size();
+    }
+
     bool create(const string& key, const Record& rec, long& elapsed_us) {
         auto start = Clock::now();
         auto p = tree_.emplace(key, rec);
@@ -132,6 +155,108 @@ private:
     map<string, Record> tree_;
 };
 
+// Cached point lookup; a miss keeps the B+Tree nearest key
+struct PointResult {
+    bool found = false;
+    Record rec;
+    string nearestKey;
+    Record nearest;
+};
+
+using Rows = vector<pair<string, Record>>;
+using RowsPtr = shared_ptr<const Rows>; // a cache hit shares rows, never copies them
+
+// Optional cache in front of both engines: CLOCK for point lookups and a
+// result cache for prefix/range scans. Every create/update/delete must call
+// invalidate() so stale results are never served.
+class QueryCache {
+public:
+    static const size_t MAX_CACHED_ROWS = 4096; // bigger scans are not cached
+
+    explicit QueryCache(size_t entries) : points_(entries), results_(entries) {}
+
+    bool getPoint(const string& key, PointResult& out, long& elapsed_us) {
+        auto start = Clock::now();
+        bool hit = points_.get(key, out);
+        elapsed_us = chrono::duration_cast<Micros>(Clock::now() - start).count();
+        return hit;
+    }
+
+    void putPoint(const string& key, const PointResult& res) {
+        size_t bytes = sizeof(PointResult) + res.rec.species.size() + res.rec.mutation.size() +
+                       res.nearestKey.size() + res.nearest.species.size() + res.nearest.mutation.size();
+        points_.put(key, res, bytes);
+    }
+
+    bool getPrefix(const string& prefix, RowsPtr& out, long& elapsed_us) {
+        return getRows(prefixKey(prefix), out, elapsed_us);
+    }
+    void putPrefix(const string& prefix, const RowsPtr& rows) { putRows(prefixKey(prefix), rows); }
+
+    bool getRange(const string& lo, const string& hi, RowsPtr& out, long& elapsed_us) {
+        return getRows(rangeKey(lo, hi), out, elapsed_us);
+    }
+    void putRange(const string& lo, const string& hi, const RowsPtr& rows) { putRows(rangeKey(lo, hi), rows); }
+
+    // Drop everything a mutation of key could have changed
+    void invalidate(const string& key) {
+        points_.erase(key);
+        // A miss's nearest key is lower_bound(query), which only moves when
+        // a key lands in [q, nearestKey). Otherwise it is the last key
+        // (nearestKey < q, "" on an empty tree), which changes whenever a
+        // key above the old last one appears.
+        points_.eraseIf([&](const string& q, const PointResult& r) {
+            if (r.found) return false;
+            bool lastKeyFallback = r.nearestKey < q;
+            return r.nearestKey == key || (q <= key && key < r.nearestKey) ||
+                   (lastKeyFallback && key > r.nearestKey);
+        });
+        results_.eraseIf([&](const string& k, const RowsPtr&) {
+            if (k[0] == 'P') return key.compare(0, k.size() - 1, k, 1, string::npos) == 0;
+            size_t sep = k.find('\0');
+            return k.compare(1, sep - 1, key) <= 0 && key <= k.substr(sep + 1);
+        });
+    }
+
+    void printStats() const {
+        cout << left << setw(10) << "Cache" << right
+             << setw(10) << "Hits" << setw(10) << "Misses" << setw(10) << "Hit %"
+             << setw(14) << "Entries" << setw(12) << "Bytes" << "\n";
+        printRow("Point", points_);
+        printRow("Result", results_);
+    }
+
+private:
+    static string prefixKey(const string& prefix) { return "P" + prefix; }
+    static string rangeKey(const string& lo, const string& hi) { return "R" + lo + '\0' + hi; }
+
+    bool getRows(const string& key, RowsPtr& out, long& elapsed_us) {
+        auto start = Clock::now();
+        bool hit = results_.get(key, out);
+        elapsed_us = chrono::duration_cast<Micros>(Clock::now() - start).count();
+        return hit;
+    }
+
+    void putRows(const string& key, const RowsPtr& rows) {
+        if (rows->size() > MAX_CACHED_ROWS) return;
+        size_t bytes = sizeof(Rows) + rows->size() * sizeof(pair<string, Record>);
+        for (auto& r : *rows) bytes += r.first.size() + r.second.species.size() + r.second.mutation.size();
+        results_.put(key, rows, bytes);
+    }
+
+    template <typename C>
+    static void printRow(const string& name, const C& c) {
+        cout << left << setw(10) << name << right
+             << setw(10) << c.hits() << setw(10) << c.misses()
+             << setw(10) << fixed << setprecision(1) << c.hitRate()
+             << setw(14) << (to_string(c.size()) + "/" + to_string(c.capacity()))
+             << setw(12) << c.bytes() << "\n";
+    }
+
+    ClockCache<PointResult> points_;
+    ClockCache<RowsPtr> results_;
+};
+
 // Load CSV: each line "key,species,mutation"
 bool loadCSV(const string& path, vector<pair<string, Record>>& out) {
     ifstream file(path);
@@ -0,0 +1,117 @@
+// Synchronous vs. coroutine-interleaved lookups across dataset sizes.
+// Build: g++ -std=c++20 -O2 coro_benchmark.cpp -o coro_benchmark
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+#include "coro_lookup.hpp"
+
+using namespace std;
+using namespace chrono;
+
+struct DNAInfo {
+    string species;
+    string mutation;
+};
+
+// Key acak ACGT sepanjang `len`, tanpa duplikat
+vector<pair<string, DNAInfo>> make_dataset(size_t n, size_t len, mt19937_64& rng) {
+    static const char bases[] = "ACGT";
+    unordered_map<string, bool> seen;
+    vector<pair<string, DNAInfo>> data;
+    data.reserve(n);
+    while (data.size() < n) {
+        string key(len, 'A');
+        for (auto& c : key) c = bases[rng() & 3];
+        if (!seen.emplace(key, true).second) continue;
+        size_t i = data.size();
+        data.emplace_back(key, DNAInfo{"Species_" + to_string(i % 10), "Mutation_" + to_string(i % 5)});
+    }
+    return data;
+}
+
+template <typename F>
+double ns_per_lookup(size_t lookups, size_t& found, F run) {
+    auto start = high_resolution_clock::now();
+    found = run();
+    return static_cast<double>(duration_cast<nanoseconds>(high_resolution_clock::now() - start).count()) / lookups;
+}
+
+// Bilangan desimal positif saja; false untuk input lain
+bool parse_positive(const string& s, size_t& out) {
+    if (s.empty() || s.size() > 18 || s.find_first_not_of("0123456789") != string::npos) return false;
+    out = stoull(s);
+    return out > 0;
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_size = 1u << 22;
+    size_t width = 16;
+    if (argc > 3 || (argc >= 2 && (!parse_positive(argv[1], max_size) || max_size < 1024)) ||
+        (argc >= 3 && !parse_positive(argv[2], width))) {
+        cerr << "Usage: " << argv[0] << " [max_size >= 1024 (default 4194304)] [in_flight >= 1 (default 16)]\n";
+        return 1;
+    }
+    const size_t num_lookups = 1u << 20;
+
+    mt19937_64 rng(42);
+    cout << "=== Lookup: synchronous vs. interleaved (" << width << " in flight) ===\n";
+    cout << "Avg. time per lookup (ns)\n";
+    cout << left << setw(10) << "Size" << right
+         << " | " << setw(10) << "Hash sync" << " | " << setw(10) << "Hash coro"
+         << " | " << setw(10) << "Stat sync" << " | " << setw(10) << "Stat coro" << "\n";
+    cout << string(10, '-') << "-+-" << string(10, '-') << "-+-" << string(10, '-')
+         << "-+-" << string(10, '-') << "-+-" << string(10, '-') << "\n";
+    cout << fixed << setprecision(2);
+
+    for (size_t n = 1u << 10; n <= max_size; n <<= 2) {
+        auto data = make_dataset(n, 16, rng);
+        unordered_map<string, DNAInfo> um(data.begin(), data.end());
+        StaticIndexDS sx;
+        sx.build(data);
+
+        vector<string> queries;
+        queries.reserve(num_lookups);
+        for (size_t i = 0; i < num_lookups; ++i) queries.push_back(data[rng() % n].first);
+
+        size_t found_hash_sync, found_hash_coro, found_stat_sync, found_stat_coro;
+        double hash_sync = ns_per_lookup(num_lookups, found_hash_sync, [&] {
+            size_t found = 0;
+            for (const auto& q : queries) found += um.count(q);
+            return found;
+        });
+        double hash_coro = ns_per_lookup(num_lookups, found_hash_coro, [&] {
+            return runInterleaved(queries, width, [&](const string& q) { return hashLookup(um, q); });
+        });
+        double stat_sync = ns_per_lookup(num_lookups, found_stat_sync, [&] {
+            size_t found = 0;
+            for (const auto& q : queries) {
+                uint64_t code;
+                if (StaticIndexDS::encode(q, code)) found += sx.keys().indexOf(code) != sx.size();
+            }
+            return found;
+        });
+        double stat_coro = ns_per_lookup(num_lookups, found_stat_coro, [&] {
+            return runInterleaved(queries, width, [&](const string& q) { return staticLookup(sx, q); });
+        });
+
+        // Mode interleaved harus menemukan hal yang sama dengan mode sinkron
+        if (found_hash_coro != found_hash_sync || found_stat_coro != found_stat_sync ||
+            found_stat_sync != found_hash_sync) {
+            cerr << "Error: found counts differ at size " << n << " (hash sync " << found_hash_sync
+                 << ", hash coro " << found_hash_coro << ", static sync " << found_stat_sync
+                 << ", static coro " << found_stat_coro << ")\n";
+            return 1;
+        }
+
+        cout << left << setw(10) << n << right
+             << " | " << setw(10) << hash_sync << " | " << setw(10) << hash_coro
+             << " | " << setw(10) << stat_sync << " | " << setw(10) << stat_coro << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+// Interleaved lookups with C++20 coroutines (compile with -std=c++20).
+// Each lookup prefetches the memory its next step needs and suspends; the
+// scheduler resumes other lookups meanwhile, hiding cache-miss latency.
+
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "static_index.hpp"
+
+using namespace std;
+
+class LookupTask {
+public:
+    struct promise_type {
+        bool found = false;
+
+        LookupTask get_return_object() {
+            return LookupTask(coroutine_handle<promise_type>::from_promise(*this));
+        }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        void return_value(bool f) { found = f; }
+        void unhandled_exception() { terminate(); }
+
+        // Frames are recycled through a per-thread free list so a lookup
+        // does not pay for a heap allocation. Lists are keyed by frame size.
+        static void* operator new(size_t size) {
+            auto& list = freeList(size);
+            if (list.empty()) return ::operator new(size);
+            void* p = list.back();
+            list.pop_back();
+            return p;
+        }
+        static void operator delete(void* p, size_t size) { freeList(size).push_back(p); }
+
+    private:
+        static vector<void*>& freeList(size_t size) {
+            struct Lists {
+                unordered_map<size_t, vector<void*>> bySize;
+                ~Lists() {
+                    for (auto& kv : bySize)
+                        for (void* p : kv.second) ::operator delete(p);
+                }
+            };
+            thread_local Lists lists;
+            return lists.bySize[size];
+        }
+    };
+
+    explicit LookupTask(coroutine_handle<promise_type> h) : h_(h) {}
+    LookupTask(LookupTask&& o) noexcept : h_(exchange(o.h_, nullptr)) {}
+    LookupTask& operator=(LookupTask&& o) noexcept {
+        if (this != &o) {
+            if (h_) h_.destroy();
+            h_ = exchange(o.h_, nullptr);
+        }
+        return *this;
+    }
+    LookupTask(const LookupTask&) = delete;
+    LookupTask& operator=(const LookupTask&) = delete;
+    ~LookupTask() {
+        if (h_) h_.destroy();
+    }
+
+    void resume() { h_.resume(); }
+    bool done() const { return h_.done(); }
+    bool found() const { return h_.promise().found; }
+
+private:
+    coroutine_handle<promise_type> h_;
+};
+
+// Hash engine: std::unordered_map only exposes its buckets, so the bucket
+// array read stays synchronous; the node fetch is what gets overlapped.
+// Keys past the short-string buffer live in their own allocation, so a
+// same-length candidate gets a second stage that prefetches its characters.
+template <typename V>
+LookupTask hashLookup(const unordered_map<string, V>& um, const string& key) {
+    size_t b = um.bucket(key);
+    auto it = um.begin(b);
+    if (it == um.end(b)) co_return false;
+    __builtin_prefetch(&*it);
+    co_await suspend_always{};
+    for (; it != um.end(b); ++it) {
+        if (it->first.size() != key.size()) continue;
+        __builtin_prefetch(it->first.data());
+        co_await suspend_always{};
+        if (it->first == key) co_return true;
+    }
+    co_return false;
+}
+
+// Ordered engine: StaticIndexDS. std::map keeps its tree links private, so
+// there is no next node to prefetch; the sorted Elias-Fano index is used.
+inline LookupTask staticLookup(const StaticIndexDS& sx, const string& key) {
+    uint64_t code;
+    if (!StaticIndexDS::encode(key, code)) co_return false;
+    const EliasFano& ef = sx.keys();
+    __builtin_prefetch(ef.bucketAddress(code));
+    co_await suspend_always{};
+    size_t pos = ef.bucketStart(code);
+    if (pos == EliasFano::NPOS) co_return false;
+    __builtin_prefetch(ef.lowAddress(ef.bucketIndex(code, pos)));
+    co_await suspend_always{};
+    co_return ef.indexFrom(code, pos) != ef.size();
+}
+
+// Runs start(key) for every key with up to `width` lookups in flight,
+// resuming them round-robin. Returns how many keys were found.
+template <typename Start>
+size_t runInterleaved(const vector<string>& keys, size_t width, Start start) {
+    vector<LookupTask> inflight;
+    inflight.reserve(width);
+    size_t next = 0, found = 0;
+    while (next < keys.size() && inflight.size() < width)
+        inflight.push_back(start(keys[next++]));
+
+    while (!inflight.empty()) {
+        for (size_t s = 0; s < inflight.size();) {
+            LookupTask& t = inflight[s];
+            t.resume();
+            if (!t.done()) {
+                ++s;
+                continue;
+            }
+            found += t.found();
+            if (next < keys.size()) {
+                t = start(keys[next++]);
+                ++s;
+            } else {
+                t = std::move(inflight.back());
+                inflight.pop_back();
+            }
+        }
+    }
+    return found;
+}
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <fstream>
 #include <sstream>
+#include "result_writer.hpp"
 
 using namespace std;
 using namespace chrono;
@@ -28,6 +29,7 @@ vector<pair<string, DNAInfo>> load_csv(const string &filename)
             getline(ss, species, ',') &&
             getline(ss, mutation, ','))
         {
+            mutation.erase(mutation.find_last_not_of(" \n\r\t") + 1);
             dataset.push_back({dna, {species, mutation}});
         }
     }
@@ -36,9 +38,15 @@ vector<pair<string, DNAInfo>> load_csv(const string &filename)
 
 int main(int argc, char *argv[])
 {
-    if (argc != 3)
+    if (argc != 3 && argc != 4)
     {
-        cout << "Usage: " << argv[0] << " <data.csv> <query>" << endl;
+        cout << "Usage: " << argv[0] << " <data.csv> <query> [table|tsv|jsonl|bin]" << endl;
+        return 1;
+    }
+    OutputFormat fmt = OutputFormat::Table;
+    if (argc == 4 && !parseOutputFormat(argv[3], fmt))
+    {
+        cout << "Unknown output format: " << argv[3] << endl;
         return 1;
     }
 
@@ -84,53 +92,49 @@ int main(int argc, char *argv[])
     size_t est_hash_mem = hash_map.size() * (sizeof(string) + sizeof(DNAInfo));
     size_t est_bpt_mem = bpt.size() * (sizeof(string) + sizeof(DNAInfo));
 
-    cout << "==== Data Size: " << n << " ====" << endl;
+    // Semua output lewat satu buffer, di-flush sekali di akhir
+    auto start_format = high_resolution_clock::now();
+    auto out = makeResultWriter(fmt);
 
     auto insert_hash_us = duration_cast<microseconds>(end_insert_hash - start_insert_hash).count();
     auto insert_bpt_us = duration_cast<microseconds>(end_insert_bpt - start_insert_bpt).count();
-    cout << "Insert Time (Hash Map) : " << insert_hash_us << " µs" << endl;
-    cout << "Insert Time (B+ Tree)  : " << insert_bpt_us << " µs" << endl
-         << endl;
-
     auto search_hash_ns = duration_cast<nanoseconds>(end_search_hash - start_search_hash).count();
     auto search_bpt_ns = duration_cast<nanoseconds>(end_search_bpt - start_search_bpt).count();
-    cout << "Search Time (Hash Map) : " << search_hash_ns << " ns" << endl;
-    cout << "Search Time (B+ Tree)  : " << search_bpt_ns << " ns" << endl
-         << endl;
 
-    cout << "Search Result:" << endl;
-
-    if (it_hash != hash_map.end())
-    {
-        cout << "- Hash Map  : 1 record found -> "
-             << it_hash->first << ": "
-             << it_hash->second.species << ", "
-             << it_hash->second.mutation << endl;
-    }
-    else
-    {
-        cout << "- Hash Map  : 0 records found" << endl;
-    }
+    out->note("==== Data Size: " + to_string(n) + " ====\n");
+    out->note("Insert Time (Hash Map) : " + to_string(insert_hash_us) + " µs\n");
+    out->note("Insert Time (B+ Tree)  : " + to_string(insert_bpt_us) + " µs\n\n");
+    out->note("Search Time (Hash Map) : " + to_string(search_hash_ns) + " ns\n");
+    out->note("Search Time (B+ Tree)  : " + to_string(search_bpt_ns) + " ns\n\n");
 
+    out->note("Search Result (Hash Map: exact, B+ Tree: prefix, " +
+              to_string(count_prefix) + " record(s)):\n");
+    out->header();
+    out->row(makeRow("HashMap", query, it_hash, it_hash != hash_map.end(), search_hash_ns));
     if (count_prefix > 0)
     {
-        cout << "- B+ Tree   : " << count_prefix << " record(s) found:" << endl;
-        for (auto &entry : bpt_results)
+        for (auto it = bpt_results.begin(); it != bpt_results.end(); ++it)
         {
-            cout << "    • " << entry.first << ": "
-                 << entry.second.species << ", "
-                 << entry.second.mutation << endl;
+            // Waktu pencarian prefix dicatat sekali, di baris pertama
+            long long t = it == bpt_results.begin() ? search_bpt_ns : -1;
+            out->row(makeRow("B+ Tree", query, it, true, t));
         }
     }
     else
     {
-        cout << "- B+ Tree   : 0 records found" << endl;
+        out->row(makeRow("B+ Tree", query, bpt_results.end(), false, search_bpt_ns));
     }
-    cout << endl;
+    out->note("\n");
 
-    cout << "Estimated Memory Usage:" << endl;
-    cout << "  - Hash Map : ~" << est_hash_mem << " bytes" << endl;
-    cout << "  - B+ Tree  : ~" << est_bpt_mem << " bytes" << endl;
+    out->note("Estimated Memory Usage:\n");
+    out->note("  - Hash Map : ~" + to_string(est_hash_mem) + " bytes\n");
+    out->note("  - B+ Tree  : ~" + to_string(est_bpt_mem) + " bytes\n");
+    if (!out->flush())
+    {
+        return 1;
+    }
+    auto format_us = duration_cast<microseconds>(high_resolution_clock::now() - start_format).count();
+    out->note("Format Time (output)   : " + to_string(format_us) + " µs\n");
 
     return 0;
 }
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Bounded key -> value cache with CLOCK (second chance) eviction.
+// A hit only sets a reference bit, so probing is a hash lookup and no list
+// reordering. Each entry carries a caller-supplied byte size for stats.
+template <typename V>
+class ClockCache {
+public:
+    explicit ClockCache(size_t capacity) : slots_(capacity) {}
+
+    bool get(const string& key, V& out) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            ++misses_;
+            return false;
+        }
+        Slot& s = slots_[it->second];
+        s.ref = true;
+        out = s.value;
+        ++hits_;
+        return true;
+    }
+
+    void put(const string& key, const V& value, size_t valueBytes) {
+        if (slots_.empty()) return;
+        auto it = index_.find(key);
+        size_t i;
+        if (it != index_.end()) {
+            i = it->second;
+            bytes_ -= slots_[i].bytes;
+        } else {
+            i = victim();
+            slots_[i].key = key;
+            slots_[i].used = true;
+            index_.emplace(key, i);
+        }
+        slots_[i].value = value;
+        slots_[i].ref = false;
+        slots_[i].bytes = key.size() + valueBytes;
+        bytes_ += slots_[i].bytes;
+    }
+
+    void erase(const string& key) {
+        auto it = index_.find(key);
+        if (it != index_.end()) release(it->second);
+    }
+
+    // Drop every entry for which pred(key, value) is true
+    template <typename Pred>
+    void eraseIf(Pred pred) {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].used && pred(slots_[i].key, slots_[i].value)) release(i);
+        }
+    }
+
+    void clear() {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].used) release(i);
+        }
+    }
+
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+    double hitRate() const {
+        size_t total = hits_ + misses_;
+        return total == 0 ? 0.0 : 100.0 * hits_ / total;
+    }
+    size_t size() const { return index_.size(); }
+    size_t capacity() const { return slots_.size(); }
+
+    // Payload bytes plus per-slot and index overhead
+    size_t bytes() const {
+        return bytes_ + slots_.size() * sizeof(Slot) +
+               index_.size() * (sizeof(string) + sizeof(size_t) + 2 * sizeof(void*));
+    }
+
+private:
+    struct Slot {
+        string key;
+        V value;
+        size_t bytes = 0;
+        bool used = false;
+        bool ref = false;
+    };
+
+    // Free slot if any, otherwise sweep the clock hand past referenced slots
+    size_t victim() {
+        if (!free_.empty()) {
+            size_t i = free_.back();
+            free_.pop_back();
+            return i;
+        }
+        if (next_ < slots_.size()) return next_++;
+        while (slots_[hand_].ref) {
+            slots_[hand_].ref = false;
+            hand_ = (hand_ + 1) % slots_.size();
+        }
+        size_t i = hand_;
+        hand_ = (hand_ + 1) % slots_.size();
+        index_.erase(slots_[i].key);
+        bytes_ -= slots_[i].bytes;
+        return i;
+    }
+
+    void release(size_t i) {
+        index_.erase(slots_[i].key);
+        bytes_ -= slots_[i].bytes;
+        slots_[i] = Slot();
+        free_.push_back(i);
+    }
+
+    vector<Slot> slots_;
+    unordered_map<string, size_t> index_;
+    vector<size_t> free_;
+    size_t next_ = 0; // slots never handed out yet start at next_
+    size_t hand_ = 0;
+    size_t bytes_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
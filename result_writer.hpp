@@ -0,0 +1,233 @@
+#pragma once
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+// One line of a lookup result
+struct ResultRow {
+    string source;        // "HashMap", "B+ Tree", "Lower Bound", ...
+    string key;           // matched key, or the queried key if not found
+    string species;
+    string mutation;
+    bool found = false;
+    long long time_ns = -1; // -1 if not measured
+};
+
+// Row from a map/unordered_map iterator; it is only dereferenced if found
+template <typename It>
+ResultRow makeRow(const string& source, const string& query, It it, bool found, long long time_ns) {
+    ResultRow r;
+    r.source = source;
+    r.key = found ? it->first : query;
+    if (found) {
+        r.species = it->second.species;
+        r.mutation = it->second.mutation;
+    }
+    r.found = found;
+    r.time_ns = time_ns;
+    return r;
+}
+
+enum class OutputFormat { Table, Tsv, JsonLines, Binary };
+
+inline bool parseOutputFormat(const string& name, OutputFormat& out) {
+    if (name == "table") out = OutputFormat::Table;
+    else if (name == "tsv") out = OutputFormat::Tsv;
+    else if (name == "jsonl") out = OutputFormat::JsonLines;
+    else if (name == "bin") out = OutputFormat::Binary;
+    else return false;
+    return true;
+}
+
+// Buffered result writer: rows are formatted into one large buffer which
+// goes out with a single write() per batch instead of a flush per line.
+class ResultWriter {
+public:
+    explicit ResultWriter(int fd = STDOUT_FILENO, size_t capacity = 1 << 16)
+        : fd_(fd), capacity_(capacity) {
+        buf_.reserve(capacity);
+    }
+    virtual ~ResultWriter() { flush(); }
+
+    virtual void header() {}
+    virtual void row(const ResultRow& r) = 0;
+
+    // Human-readable text (titles, timings). Inline for the table format,
+    // on stderr for machine formats so stdout stays parseable.
+    virtual void note(const string& text) { cerr << text; }
+
+    // Returns false if write() failed. The error is reported once on stderr;
+    // after that the writer drops all further output.
+    bool flush() {
+        if (failed_) return false;
+        if (buf_.empty()) return true;
+        if (fd_ == STDOUT_FILENO) cout.flush(); // keep ordering with earlier cout output
+        size_t done = 0;
+        while (done < buf_.size()) {
+            ssize_t w = ::write(fd_, buf_.data() + done, buf_.size() - done);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) {
+                int err = w < 0 ? errno : EIO;
+                failed_ = true;
+                cerr << "Error: write failed, " << buf_.size() - done << " bytes not written: "
+                     << strerror(err) << "\n";
+                buf_.clear();
+                return false;
+            }
+            done += w;
+        }
+        buf_.clear();
+        return true;
+    }
+
+protected:
+    void put(const char* s, size_t n) {
+        if (buf_.size() + n > capacity_ && !flush()) return;
+        buf_.append(s, n);
+    }
+    void put(const string& s) { put(s.data(), s.size()); }
+    void put(char c) { put(&c, 1); }
+    void putNumber(long long v) { put(to_string(v)); }
+
+private:
+    int fd_;
+    size_t capacity_;
+    string buf_;
+    bool failed_ = false;
+};
+
+// Aligned text table, same layout as the original findSingle output
+class TableWriter : public ResultWriter {
+public:
+    using ResultWriter::ResultWriter;
+
+    void header() override {
+        cell("Structure", 12); put(" | ");
+        cell("Key", 20); put(" | ");
+        cell("Species", 15); put(" | ");
+        cell("Mutation", 15); put(" | ");
+        put("Time (ns)\n");
+        put(string(12, '-') + "-|-" + string(20, '-') + "-|-" + string(15, '-') + "-|-" +
+            string(15, '-') + "-|-" + string(10, '-') + "\n");
+    }
+
+    void row(const ResultRow& r) override {
+        cell(r.source, 12); put(" | ");
+        cell(r.found ? r.key : "Not Found", 20); put(" | ");
+        cell(r.found ? r.species : "-", 15); put(" | ");
+        cell(r.found ? r.mutation : "-", 15); put(" | ");
+        if (r.time_ns >= 0) putNumber(r.time_ns);
+        put('\n');
+    }
+
+    void note(const string& text) override { put(text); }
+
+private:
+    void cell(const string& s, size_t width) {
+        put(s);
+        if (s.size() < width) put(string(width - s.size(), ' '));
+    }
+};
+
+class TsvWriter : public ResultWriter {
+public:
+    using ResultWriter::ResultWriter;
+
+    void header() override { put("structure\tkey\tspecies\tmutation\tfound\ttime_ns\n"); }
+
+    void row(const ResultRow& r) override {
+        put(r.source); put('\t');
+        put(r.key); put('\t');
+        put(r.species); put('\t');
+        put(r.mutation); put('\t');
+        put(r.found ? '1' : '0'); put('\t');
+        if (r.time_ns >= 0) putNumber(r.time_ns);
+        put('\n');
+    }
+};
+
+class JsonLinesWriter : public ResultWriter {
+public:
+    using ResultWriter::ResultWriter;
+
+    void row(const ResultRow& r) override {
+        put("{\"structure\":"); str(r.source);
+        put(",\"key\":"); str(r.key);
+        put(",\"species\":"); str(r.species);
+        put(",\"mutation\":"); str(r.mutation);
+        put(r.found ? ",\"found\":true" : ",\"found\":false");
+        put(",\"time_ns\":");
+        if (r.time_ns >= 0) putNumber(r.time_ns);
+        else put("null");
+        put("}\n");
+    }
+
+private:
+    void str(const string& s) {
+        static const char hex[] = "0123456789abcdef";
+        put('"');
+        for (unsigned char c : s) {
+            if (c == '"' || c == '\\') {
+                put('\\');
+                put((char)c);
+            } else if (c < 0x20) {
+                put("\\u00");
+                put(hex[c >> 4]);
+                put(hex[c & 15]);
+            } else {
+                put((char)c);
+            }
+        }
+        put('"');
+    }
+};
+
+// Compact binary records, little-endian:
+//   header: "DNAR" u8 version(1)
+//   row:    u8 found, 4 x (u16 length + bytes) for source/key/species/mutation,
+//           i64 time_ns
+class BinaryWriter : public ResultWriter {
+public:
+    using ResultWriter::ResultWriter;
+
+    void header() override {
+        put("DNAR", 4);
+        put((char)1);
+    }
+
+    void row(const ResultRow& r) override {
+        put((char)(r.found ? 1 : 0));
+        str(r.source);
+        str(r.key);
+        str(r.species);
+        str(r.mutation);
+        uint64_t t = (uint64_t)r.time_ns;
+        for (int i = 0; i < 8; ++i) put((char)(t >> (8 * i)));
+    }
+
+private:
+    void str(const string& s) {
+        size_t n = s.size() > 0xFFFF ? 0xFFFF : s.size();
+        put((char)(n & 0xFF));
+        put((char)(n >> 8));
+        put(s.data(), n);
+    }
+};
+
+inline unique_ptr<ResultWriter> makeResultWriter(OutputFormat fmt, int fd = STDOUT_FILENO) {
+    switch (fmt) {
+        case OutputFormat::Tsv: return unique_ptr<ResultWriter>(new TsvWriter(fd));
+        case OutputFormat::JsonLines: return unique_ptr<ResultWriter>(new JsonLinesWriter(fd));
+        case OutputFormat::Binary: return unique_ptr<ResultWriter>(new BinaryWriter(fd));
+        default: return unique_ptr<ResultWriter>(new TableWriter(fd));
+    }
+}
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Fixed-width integer array packed into 64-bit words
+class PackedArray {
+public:
+    void init(size_t n, int width) {
+        n_ = n;
+        width_ = width;
+        words_.assign(width == 0 ? 0 : (n * width + 63) / 64 + 1, 0);
+    }
+
+    void set(size_t i, uint64_t v) {
+        if (width_ == 0) return;
+        size_t bit = i * width_;
+        size_t w = bit / 64, off = bit % 64;
+        uint64_t mask = width_ == 64 ? ~0ULL : (1ULL << width_) - 1;
+        v &= mask;
+        words_[w] = (words_[w] & ~(mask << off)) | (v << off);
+        if (off + width_ > 64) {
+            int spill = off + width_ - 64;
+            words_[w + 1] = (words_[w + 1] & ~((1ULL << spill) - 1)) | (v >> (width_ - spill));
+        }
+    }
+
+    uint64_t get(size_t i) const {
+        if (width_ == 0) return 0;
+        size_t bit = i * width_;
+        size_t w = bit / 64, off = bit % 64;
+        uint64_t mask = width_ == 64 ? ~0ULL : (1ULL << width_) - 1;
+        uint64_t v = words_[w] >> off;
+        if (off + width_ > 64) v |= words_[w + 1] << (64 - off);
+        return v & mask;
+    }
+
+    const void* address(size_t i) const {
+        return words_.empty() ? nullptr : &words_[i * width_ / 64];
+    }
+
+    size_t size() const { return n_; }
+    size_t bytes() const { return words_.size() * sizeof(uint64_t); }
+
+private:
+    size_t n_ = 0;
+    int width_ = 0;
+    vector<uint64_t> words_;
+};
+
+// Elias-Fano encoding of a sorted sequence of 64-bit values
+class EliasFano {
+public:
+    void build(const vector<uint64_t>& sorted) {
+        n_ = sorted.size();
+        high_.clear();
+        samples_.clear();
+        zeroSamples_.clear();
+        if (n_ == 0) {
+            low_.init(0, 0);
+            return;
+        }
+        uint64_t maxValue = sorted.back();
+        lowBits_ = maxValue / n_ > 0 ? 63 - __builtin_clzll(maxValue / n_) : 0;
+        low_.init(n_, lowBits_);
+
+        size_t highBits = n_ + (maxValue >> lowBits_) + 1;
+        high_.assign((highBits + 63) / 64, 0);
+        for (size_t i = 0; i < n_; ++i) {
+            uint64_t v = sorted[i];
+            size_t pos = (v >> lowBits_) + i;
+            high_[pos / 64] |= 1ULL << (pos % 64);
+            low_.set(i, v);
+            if (i % SAMPLE_RATE == 0) samples_.push_back(pos);
+        }
+        maxHigh_ = maxValue >> lowBits_;
+        for (uint64_t z = 0, pos = 0; z <= maxHigh_; ++pos) {
+            if (high_[pos / 64] >> (pos % 64) & 1) continue;
+            if (z % SAMPLE_RATE == 0) zeroSamples_.push_back(pos);
+            ++z;
+        }
+    }
+
+    uint64_t at(size_t i) const {
+        uint64_t high = select1(i) - i;
+        return (high << lowBits_) | low_.get(i);
+    }
+
+    // Calls f(i, value) for i in [first, last): one select, then walks the
+    // set bits of high_ in order instead of selecting every element.
+    template <typename F>
+    void forEach(size_t first, size_t last, F f) const {
+        if (first >= last) return;
+        size_t pos = select1(first);
+        for (size_t i = first; i < last; ++i) {
+            if (i > first) pos = nextOne(pos);
+            f(i, ((uint64_t)(pos - i) << lowBits_) | low_.get(i));
+        }
+    }
+
+    // First index whose value is >= v (size() if none).
+    // Jumps to the bucket of v's high bits, then scans only that bucket.
+    size_t lowerBound(uint64_t v) const {
+        size_t pos = bucketStart(v);
+        if (pos == NPOS) return n_;
+        size_t i = bucketIndex(v, pos);
+        for (; i < n_; ++pos, ++i) {
+            if (!(high_[pos / 64] >> (pos % 64) & 1)) return i; // end of bucket
+            if (low_.get(i) >= lowPart(v)) return i;
+        }
+        return n_;
+    }
+
+    // Index of value v, or size() if absent
+    size_t indexOf(uint64_t v) const {
+        size_t pos = bucketStart(v);
+        return pos == NPOS ? n_ : indexFrom(v, pos);
+    }
+
+    // indexOf split into stages for interleaved lookups: bucketAddress() is
+    // the cache line bucketStart() reads, lowAddress() the one indexFrom() reads.
+    static const size_t NPOS = ~(size_t)0;
+
+    const void* bucketAddress(uint64_t v) const {
+        uint64_t h = v >> lowBits_;
+        if (n_ == 0 || h == 0 || h > maxHigh_) return high_.data();
+        return &high_[zeroSamples_[(h - 1) / SAMPLE_RATE] / 64];
+    }
+
+    // Bit position in high_ where v's bucket starts, NPOS if v > all values
+    size_t bucketStart(uint64_t v) const {
+        uint64_t h = v >> lowBits_;
+        if (n_ == 0 || h > maxHigh_) return NPOS;
+        return h == 0 ? 0 : select0(h - 1) + 1;
+    }
+
+    size_t bucketIndex(uint64_t v, size_t pos) const { return pos - (v >> lowBits_); }
+
+    const void* lowAddress(size_t i) const { return low_.address(i); }
+
+    size_t indexFrom(uint64_t v, size_t pos) const {
+        size_t i = bucketIndex(v, pos);
+        for (; i < n_ && (high_[pos / 64] >> (pos % 64) & 1); ++pos, ++i) {
+            uint64_t cur = low_.get(i);
+            if (cur >= lowPart(v)) return cur == lowPart(v) ? i : n_;
+        }
+        return n_;
+    }
+
+    size_t size() const { return n_; }
+    size_t bytes() const {
+        return high_.size() * sizeof(uint64_t) + low_.bytes() +
+               (samples_.size() + zeroSamples_.size()) * sizeof(uint64_t);
+    }
+
+private:
+    static const size_t SAMPLE_RATE = 256;
+
+    uint64_t lowPart(uint64_t v) const {
+        return lowBits_ == 0 ? 0 : v & (~0ULL >> (64 - lowBits_));
+    }
+
+    // Bit position of the i-th set bit in high_
+    size_t select1(size_t i) const {
+        size_t pos = samples_[i / SAMPLE_RATE];
+        size_t remaining = i % SAMPLE_RATE;
+        size_t w = pos / 64;
+        uint64_t word = high_[w] & (~0ULL << (pos % 64));
+        while (true) {
+            size_t c = __builtin_popcountll(word);
+            if (remaining < c) {
+                for (; remaining > 0; --remaining) word &= word - 1;
+                return w * 64 + __builtin_ctzll(word);
+            }
+            remaining -= c;
+            word = high_[++w];
+        }
+    }
+
+    // Position of the first set bit after pos; the caller guarantees one exists
+    size_t nextOne(size_t pos) const {
+        ++pos;
+        size_t w = pos / 64;
+        uint64_t word = high_[w] & (~0ULL << (pos % 64));
+        while (word == 0) word = high_[++w];
+        return w * 64 + __builtin_ctzll(word);
+    }
+
+    // Bit position of the i-th zero bit in high_
+    size_t select0(size_t i) const {
+        size_t pos = zeroSamples_[i / SAMPLE_RATE];
+        size_t remaining = i % SAMPLE_RATE;
+        size_t w = pos / 64;
+        uint64_t word = ~high_[w] & (~0ULL << (pos % 64));
+        while (true) {
+            size_t c = __builtin_popcountll(word);
+            if (remaining < c) {
+                for (; remaining > 0; --remaining) word &= word - 1;
+                return w * 64 + __builtin_ctzll(word);
+            }
+            remaining -= c;
+            word = ~high_[++w];
+        }
+    }
+
+    size_t n_ = 0;
+    int lowBits_ = 0;
+    uint64_t maxHigh_ = 0;
+    vector<uint64_t> high_;
+    PackedArray low_;
+    vector<uint64_t> samples_;
+    vector<uint64_t> zeroSamples_;
+};
+
+// Dictionary-coded string column
+class DictColumn {
+public:
+    void build(const vector<const string*>& values) {
+        dict_.clear();
+        unordered_map<string, uint64_t> ids;
+        vector<uint64_t> raw;
+        raw.reserve(values.size());
+        for (auto* v : values) {
+            auto p = ids.emplace(*v, dict_.size());
+            if (p.second) dict_.push_back(*v);
+            raw.push_back(p.first->second);
+        }
+        int width = dict_.size() > 1 ? 64 - __builtin_clzll(dict_.size() - 1) : 0;
+        codes_.init(raw.size(), width);
+        for (size_t i = 0; i < raw.size(); ++i) codes_.set(i, raw[i]);
+    }
+
+    const string& at(size_t i) const { return dict_[codes_.get(i)]; }
+
+    size_t bytes() const {
+        size_t total = codes_.bytes() + dict_.size() * sizeof(string);
+        for (auto& s : dict_) total += s.size() + 1;
+        return total;
+    }
+
+private:
+    vector<string> dict_;
+    PackedArray codes_;
+};
+
+// Read-only index over DNA keys: keys are 2-bit packed (A,C,G,T) and
+// stored sorted in an Elias-Fano array, species/mutation are dictionary coded.
+// Keys up to MAX_BASES long; the encoding preserves lexicographic order.
+class StaticIndexDS {
+public:
+    static const int MAX_BASES = 29;
+
+    // Returns false if a key is not pure ACGT or longer than MAX_BASES.
+    // Duplicate keys keep their first record, like map::insert.
+    template <typename Rec>
+    bool build(const vector<pair<string, Rec>>& data) {
+        vector<pair<uint64_t, size_t>> order;
+        order.reserve(data.size());
+        for (size_t i = 0; i < data.size(); ++i) {
+            uint64_t code;
+            if (!encode(data[i].first, code)) return false;
+            order.emplace_back(code, i);
+        }
+        stable_sort(order.begin(), order.end(),
+                    [](const pair<uint64_t, size_t>& a, const pair<uint64_t, size_t>& b) {
+                        return a.first < b.first;
+                    });
+        order.erase(unique(order.begin(), order.end(),
+                           [](const pair<uint64_t, size_t>& a, const pair<uint64_t, size_t>& b) {
+                               return a.first == b.first;
+                           }),
+                    order.end());
+
+        vector<uint64_t> codes;
+        vector<const string*> species, mutation;
+        codes.reserve(order.size());
+        species.reserve(order.size());
+        mutation.reserve(order.size());
+        for (auto& o : order) {
+            codes.push_back(o.first);
+            species.push_back(&data[o.second].second.species);
+            mutation.push_back(&data[o.second].second.mutation);
+        }
+        keys_.build(codes);
+        species_.build(species);
+        mutation_.build(mutation);
+        return true;
+    }
+
+    template <typename Rec>
+    bool find(const string& key, Rec& out) const {
+        uint64_t code;
+        if (!encode(key, code)) return false;
+        size_t i = keys_.indexOf(code);
+        if (i == keys_.size()) return false;
+        out = Rec{species_.at(i), mutation_.at(i)};
+        return true;
+    }
+
+    // Smallest key >= key, or the last key if none
+    template <typename Rec>
+    bool findNearest(const string& key, string& nearestKey, Rec& out) const {
+        if (keys_.size() == 0) return false;
+        size_t i = keys_.lowerBound(lowerCode(key));
+        if (i == keys_.size()) i = keys_.size() - 1;
+        nearestKey = decode(keys_.at(i));
+        out = Rec{species_.at(i), mutation_.at(i)};
+        return true;
+    }
+
+    // All keys starting with prefix, in sorted order
+    template <typename Rec>
+    size_t prefixSearch(const string& prefix, vector<pair<string, Rec>>& out) const {
+        uint64_t packed;
+        if (prefix.size() > MAX_BASES || !pack(prefix, packed)) return 0;
+        size_t first = keys_.lowerBound((packed << 6) | prefix.size());
+        uint64_t next = packed + (1ULL << (2 * (MAX_BASES - prefix.size())));
+        size_t last = (next >> (2 * MAX_BASES)) ? keys_.size() : keys_.lowerBound(next << 6);
+        return collect(first, last, out);
+    }
+
+    // All keys in [lo, hi], in sorted order
+    template <typename Rec>
+    size_t rangeSearch(const string& lo, const string& hi, vector<pair<string, Rec>>& out) const {
+        uint64_t hiCode = lowerCode(hi);
+        size_t first = keys_.lowerBound(lowerCode(lo));
+        size_t last = keys_.lowerBound(hiCode);
+        if (last < keys_.size() && keys_.at(last) == hiCode) {
+            uint64_t exact;
+            if (encode(hi, exact)) ++last;
+        }
+        return collect(first, last, out);
+    }
+
+    size_t size() const { return keys_.size(); }
+    size_t bytes() const { return keys_.bytes() + species_.bytes() + mutation_.bytes(); }
+
+    const EliasFano& keys() const { return keys_; }
+
+    // Packed bases in the high 58 bits, key length in the low 6 bits
+    static bool encode(const string& key, uint64_t& code) {
+        uint64_t packed;
+        if (key.size() > MAX_BASES || !pack(key, packed)) return false;
+        code = (packed << 6) | key.size();
+        return true;
+    }
+
+private:
+    static int baseCode(char c) {
+        switch (c) {
+            case 'A': return 0;
+            case 'C': return 1;
+            case 'G': return 2;
+            case 'T': return 3;
+            default: return -1;
+        }
+    }
+
+    // Left-aligned 2-bit packing, padded with A (= 0) up to MAX_BASES
+    static bool pack(const string& key, uint64_t& packed) {
+        packed = 0;
+        for (int i = 0; i < MAX_BASES; ++i) {
+            int b = 0;
+            if (i < (int)key.size()) {
+                b = baseCode(key[i]);
+                if (b < 0) return false;
+            }
+            packed = (packed << 2) | b;
+        }
+        return true;
+    }
+
+    static string decode(uint64_t code) {
+        static const char bases[] = "ACGT";
+        size_t len = code & 63;
+        uint64_t packed = code >> 6;
+        string key(len, 'A');
+        for (size_t i = 0; i < len; ++i)
+            key[i] = bases[(packed >> (2 * (MAX_BASES - 1 - i))) & 3];
+        return key;
+    }
+
+    // Smallest code whose key is >= key, also for keys that cannot be encoded
+    static uint64_t lowerCode(const string& key) {
+        uint64_t code;
+        if (encode(key, code)) return code;
+        uint64_t packed = 0;
+        size_t len = 0;
+        for (; len < key.size() && len < (size_t)MAX_BASES; ++len) {
+            int b = baseCode(key[len]);
+            if (b < 0) break;
+            packed |= (uint64_t)b << (2 * (MAX_BASES - 1 - len));
+        }
+        if (len == (size_t)MAX_BASES) // longer than MAX_BASES: next after the truncated key
+            return ((packed << 6) | MAX_BASES) + 1;
+        // First non-ACGT char: order it against the bases it falls between,
+        // unsigned like string::compare so bytes >= 0x80 sort after 'T'
+        unsigned char c = key[len];
+        int next = c < 'A' ? 0 : c < 'C' ? 1 : c < 'G' ? 2 : c < 'T' ? 3 : 4;
+        if (next == 4) { // after T: skip every key extending this prefix
+            uint64_t prefixPacked = packed + (3ULL << (2 * (MAX_BASES - 1 - len)));
+            uint64_t end = prefixPacked + (1ULL << (2 * (MAX_BASES - 1 - len)));
+            if (end >> (2 * MAX_BASES)) return ~0ULL;
+            return end << 6;
+        }
+        packed |= (uint64_t)next << (2 * (MAX_BASES - 1 - len));
+        return packed << 6 | (len + 1);
+    }
+
+    template <typename Rec>
+    size_t collect(size_t first, size_t last, vector<pair<string, Rec>>& out) const {
+        keys_.forEach(first, last, [&](size_t i, uint64_t code) {
+            out.emplace_back(decode(code), Rec{species_.at(i), mutation_.at(i)});
+        });
+        return last > first ? last - first : 0;
+    }
+
+    EliasFano keys_;
+    DictColumn species_;
+    DictColumn mutation_;
+};
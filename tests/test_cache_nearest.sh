@@ -0,0 +1,46 @@
+#!/bin/sh
+# Cached misses and their nearest key: dropped exactly when a mutation can
+# move the nearest key, kept otherwise.
+set -e
+cd "$(dirname "$0")/.."
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+g++ -std=gnu++17 -O2 benchmark_menu.cpp -o "$tmp/benchmark_menu"
+
+printf 'AAA,S1,M1\nCCC,S2,M2\n' > "$tmp/two.csv"
+printf 'find GGG\ncreate EEE Sx Mx\nfind GGG\nexit\n' |
+    "$tmp/benchmark_menu" "$tmp/two.csv" --cache > "$tmp/out.txt"
+if grep -q 'Cache: .*"GGG".*Nearest: \[CCC\]' "$tmp/out.txt" ||
+   ! grep -q 'Nearest: \[EEE\]' "$tmp/out.txt"; then
+    echo "FAIL: stale nearest key after create"
+    cat "$tmp/out.txt"
+    exit 1
+fi
+
+: > "$tmp/empty.csv"
+printf 'find GGG\ncreate EEE Sx Mx\nfind GGG\nexit\n' |
+    "$tmp/benchmark_menu" "$tmp/empty.csv" --cache > "$tmp/out.txt"
+if ! grep -q 'Nearest: \[EEE\]' "$tmp/out.txt"; then
+    echo "FAIL: stale nearest key after create on empty tree"
+    cat "$tmp/out.txt"
+    exit 1
+fi
+
+# Mutations outside [query, nearest) must keep the cached miss; a key
+# landing inside it must drop the miss.
+printf 'AAA,S1,M1\nCCC,S2,M2\nGGG,S3,M3\n' > "$tmp/three.csv"
+printf 'find CAA\ncreate TTT Sx Mx\ndelete ZZZ\nupdate GGG Sy My\nfind CAA\ncreate CAB Sz Mz\nfind CAA\nexit\n' |
+    "$tmp/benchmark_menu" "$tmp/three.csv" --cache > "$tmp/out.txt"
+if ! grep -q 'Cache: .*"CAA".*Nearest: \[CCC\]' "$tmp/out.txt"; then
+    echo "FAIL: unrelated mutation dropped a cached miss"
+    cat "$tmp/out.txt"
+    exit 1
+fi
+if ! grep -q 'B+Tree: .*"CAA".*Nearest: \[CAB\]' "$tmp/out.txt"; then
+    echo "FAIL: stale nearest key after create inside [query, nearest)"
+    cat "$tmp/out.txt"
+    exit 1
+fi
+
+echo "PASS"
@@ -0,0 +1,105 @@
+// Randomized check of StaticIndexDS against std::map: find, nearest,
+// prefix and range, including queries with non-ACGT and >= 0x80 bytes.
+#include <iostream>
+#include <map>
+#include <random>
+#include "../static_index.hpp"
+
+struct Record {
+    string species;
+    string mutation;
+};
+
+static int failures = 0;
+
+static void fail(const string& what, const string& query) {
+    if (++failures <= 10) {
+        cerr << "FAIL: " << what << " for query \"";
+        for (unsigned char c : query) {
+            if (c >= 0x20 && c < 0x7f) cerr << c;
+            else cerr << "\\x" << hex << (int)c << dec;
+        }
+        cerr << "\"\n";
+    }
+}
+
+static string randomKey(mt19937& rng, size_t maxLen, bool anyByte) {
+    static const char bases[] = "ACGT";
+    static const char others[] = {'\x01', '@', 'B', 'Z', 'a', '\x7f', '\x80', '\xC3', '\xFF'};
+    string key;
+    size_t len = rng() % (maxLen + 1);
+    for (size_t i = 0; i < len; ++i) {
+        if (anyByte && rng() % 5 == 0) key += others[rng() % sizeof(others)];
+        else key += bases[rng() % 4];
+    }
+    return key;
+}
+
+static bool sameRows(const vector<pair<string, Record>>& got, map<string, Record>::const_iterator from,
+                     map<string, Record>::const_iterator to) {
+    size_t i = 0;
+    for (auto it = from; it != to; ++it, ++i) {
+        if (i >= got.size() || got[i].first != it->first || got[i].second.species != it->second.species)
+            return false;
+    }
+    return i == got.size();
+}
+
+int main() {
+    mt19937 rng(12345);
+    for (int round = 0; round < 300; ++round) {
+        size_t n = rng() % 3000;
+        size_t maxLen = round % 5 == 0 ? StaticIndexDS::MAX_BASES : 10;
+        vector<pair<string, Record>> data;
+        map<string, Record> ref;
+        for (size_t i = 0; i < n; ++i) {
+            string key = randomKey(rng, maxLen, false);
+            Record rec{"Species_" + to_string(rng() % 40), "Mutation_" + to_string(i)};
+            data.emplace_back(key, rec);
+            ref.insert({key, rec});
+        }
+
+        StaticIndexDS sx;
+        if (!sx.build(data) || sx.size() != ref.size()) {
+            cerr << "FAIL: build, round " << round << "\n";
+            return 1;
+        }
+
+        for (int q = 0; q < 200; ++q) {
+            string key = randomKey(rng, 10, true);
+            Record rec;
+
+            auto it = ref.find(key);
+            bool found = sx.find(key, rec);
+            if (found != (it != ref.end()) || (found && rec.mutation != it->second.mutation))
+                fail("find", key);
+
+            string nearest;
+            if (!ref.empty() && sx.findNearest(key, nearest, rec)) {
+                auto lb = ref.lower_bound(key);
+                if (lb == ref.end()) lb = prev(ref.end());
+                if (nearest != lb->first) fail("findNearest", key);
+            }
+
+            if (key.find_first_not_of("ACGT") == string::npos) {
+                vector<pair<string, Record>> rows;
+                sx.prefixSearch(key, rows);
+                auto end = ref.lower_bound(key);
+                while (end != ref.end() && end->first.compare(0, key.size(), key) == 0) ++end;
+                if (!sameRows(rows, ref.lower_bound(key), end)) fail("prefixSearch", key);
+            }
+
+            string other = randomKey(rng, 10, true);
+            string lo = min(key, other), hi = max(key, other);
+            vector<pair<string, Record>> rows;
+            sx.rangeSearch(lo, hi, rows);
+            if (!sameRows(rows, ref.lower_bound(lo), ref.upper_bound(hi))) fail("rangeSearch", lo + ".." + hi);
+        }
+    }
+    if (failures > 0) {
+        cerr << failures << " mismatch(es)\n";
+        return 1;
+    }
+    cout << "PASS\n";
+    return 0;
+}
@@ -0,0 +1,9 @@
+#!/bin/sh
+# Randomized differential check of the static index against std::map.
+set -e
+cd "$(dirname "$0")/.."
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+g++ -std=gnu++17 -O2 tests/test_static_index.cpp -o "$tmp/test_static_index"
+"$tmp/test_static_index"
@@ -0,0 +1,27 @@
+#!/bin/sh
+# A failed write must be reported once and must not retry or keep
+# buffering for the rest of the output.
+set -e
+cd "$(dirname "$0")/.."
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+g++ -std=gnu++17 -O2 dna_lookup.cpp -o "$tmp/lookup"
+
+# 20000 rows with 7-base keys: a prefix query for "A" fills several buffers
+awk 'BEGIN { srand(1); split("A C G T", b, " ");
+             for (i = 0; i < 20000; i++) {
+                 k = ""; for (j = 0; j < 7; j++) k = k b[int(rand() * 4) + 1];
+                 print k ",Species_" i % 10 ",Mutation_" i % 5 } }' > "$tmp/big.csv"
+
+if "$tmp/lookup" "$tmp/big.csv" A tsv > /dev/full 2> "$tmp/err.txt"; then
+    echo "FAIL: expected a non-zero exit status on write failure"
+    exit 1
+fi
+errors=$(grep -c "write failed" "$tmp/err.txt" || true)
+if [ "$errors" -ne 1 ]; then
+    echo "FAIL: expected 1 write error, got $errors"
+    exit 1
+fi
+
+echo "PASS"